@@ -22,18 +22,33 @@
  * SOFTWARE.
  */
 
+#define _GNU_SOURCE  /* secure_getenv() */
+#include <dlfcn.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <gpiow/gpiow.h>
 #include <gpiow/multi_impl.h>
 
+#define DEFAULT_SCHEME "pigpiod"
+#define MAX_SCHEME_LEN 32
+
 static struct gpw_i2c_impl_entry *impl_list = NULL;
 
+#ifdef GPIOW_STATIC_PIGPIOD
 extern void gpiow_pigpiod_initialize(void);
+#endif
 
 void gpiow_initialize(void)
 {
+    /*
+     * Backends built as modules are not touched here. They are loaded by
+     * gpw_i2c_bus_create() when their URI scheme is used for the first time.
+     */
+#ifdef GPIOW_STATIC_PIGPIOD
     gpiow_pigpiod_initialize();
+#endif
 }
 
 void gpw_i2c_bus_register(struct gpw_i2c_impl_entry *entry)
@@ -45,16 +60,105 @@ void gpw_i2c_bus_register(struct gpw_i2c_impl_entry *entry)
             gpiow_log(GPIOW_LOG_ERROR, "%s: %s is alredy registered", __func__, entry->name);
             return;
         }
+        p = &(*p)->next;
     }
     gpiow_log(GPIOW_LOG_DEBUG, "%s: %s is registered", __func__, entry->name);
     entry->next = impl_list;
     impl_list = entry;
 }
 
+static int get_scheme(char *uri, char *buf, int size)
+{
+    int i;
+
+    if (uri == NULL) {
+        uri = DEFAULT_SCHEME;
+    }
+    for (i = 0; i < size - 1 && uri[i] != ':' && uri[i] != '\0'; i++) {
+        /* The scheme becomes part of a file name, don't accept anything else */
+        if (!('a' <= uri[i] && uri[i] <= 'z') && !('0' <= uri[i] && uri[i] <= '9') &&
+            uri[i] != '_') {
+            return -1;
+        }
+        buf[i] = uri[i];
+    }
+    if (i == 0 || (uri[i] != ':' && uri[i] != '\0')) {
+        return -1;
+    }
+    buf[i] = '\0';
+
+    return 0;
+}
+
+static int is_registered(char *name)
+{
+    struct gpw_i2c_impl_entry *impl;
+
+    for (impl = impl_list; impl; impl = impl->next) {
+        if (impl->name && strcmp(impl->name, name) == 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int load_module(char *scheme)
+{
+    char path[256];
+    char func_name[MAX_SCHEME_LEN + 32];
+    char *dir;
+    void *handle;
+    void (*initialize)(void);
+    int n;
+
+    /* Ignored in setuid/setgid processes, like LD_LIBRARY_PATH */
+    dir = secure_getenv("GPIOW_MODULE_DIR");
+    if (dir == NULL) {
+        dir = GPIOW_MODULE_DIR;
+    }
+    n = snprintf(path, sizeof(path), "%s/libgpiow_%s.so", dir, scheme);
+    if (n < 0 || sizeof(path) <= n) {
+        gpiow_log(GPIOW_LOG_ERROR, "%s: module path for \"%s\" is too long", __func__, scheme);
+        return -1;
+    }
+    if (access(path, F_OK) == 0) {
+        handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        if (handle == NULL) {
+            gpiow_log(GPIOW_LOG_ERROR, "%s: can't load %s, %s", __func__, path, dlerror());
+            return -1;
+        }
+    } else {
+        /* Fall back to the dynamic linker's search path */
+        snprintf(path, sizeof(path), "libgpiow_%s.so", scheme);
+        handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        if (handle == NULL) {
+            gpiow_log(GPIOW_LOG_WARN, "%s: no module for \"%s\", %s", __func__, scheme,
+                      dlerror());
+            return -1;
+        }
+    }
+
+    snprintf(func_name, sizeof(func_name), "gpiow_%s_initialize", scheme);
+    *(void **)&initialize = dlsym(handle, func_name);
+    if (initialize == NULL) {
+        gpiow_log(GPIOW_LOG_ERROR, "%s: %s not found in %s", __func__, func_name, path);
+        dlclose(handle);
+        return -1;
+    }
+    gpiow_log(GPIOW_LOG_DEBUG, "%s: %s is loaded", __func__, path);
+
+    /* The module stays loaded for the lifetime of the process */
+    (*initialize)();
+
+    return 0;
+}
+
 struct gpw_i2c_bus *gpw_i2c_bus_create(char* uri)
 {
     struct gpw_i2c_impl_entry *impl = impl_list;
     struct gpw_i2c_bus *bus;
+    char scheme[MAX_SCHEME_LEN];
 
     while (impl) {
         if (impl->create && (bus = (*impl->create)(uri)) != NULL) {
@@ -63,6 +167,18 @@ struct gpw_i2c_bus *gpw_i2c_bus_create(char* uri)
         impl = impl->next;
     }
 
+    /* Load the backend for the scheme on first use and try again */
+    if (get_scheme(uri, scheme, sizeof(scheme)) != 0) {
+        gpiow_log(GPIOW_LOG_WARN, "%s: invalid scheme in URI, \"%s\"", __func__, uri);
+    } else if (!is_registered(scheme) && load_module(scheme) == 0) {
+        for (impl = impl_list; impl; impl = impl->next) {
+            if (impl->name && strcmp(impl->name, scheme) == 0 && impl->create &&
+                (bus = (*impl->create)(uri)) != NULL) {
+                return bus;
+            }
+        }
+    }
+
     gpiow_log(GPIOW_LOG_WARN, "%s: can't create instance for %s", __func__, uri);
 
     return NULL;
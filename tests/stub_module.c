@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 hanyazou
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Stub backend module for the loader test. STUB_NAME is the URI scheme it
+ * serves; with STUB_NO_INIT the gpiow_<scheme>_initialize() entry is omitted.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <gpiow/gpiow.h>
+#include <gpiow/multi_impl.h>
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+#define CAT_(a, b, c) a ## b ## c
+#define CAT(a, b, c) CAT_(a, b, c)
+
+#define IMPL_NAME STR(STUB_NAME)
+
+static void stub_i2c_release(struct gpw_i2c_bus *bus)
+{
+    free(bus);
+}
+
+static struct gpw_i2c_bus *stub_i2c_create(char* uri)
+{
+    struct gpw_i2c_bus *bus;
+
+    if (uri == NULL) {
+        if (strcmp(IMPL_NAME, "pigpiod") != 0) {
+            return NULL;
+        }
+    } else if (strncmp(uri, IMPL_NAME, sizeof(IMPL_NAME) - 1) != 0 ||
+               (uri[sizeof(IMPL_NAME) - 1] != ':' && uri[sizeof(IMPL_NAME) - 1] != '\0')) {
+        return NULL;
+    }
+
+    bus = calloc(1, sizeof(*bus));
+    if (bus == NULL) {
+        return NULL;
+    }
+    bus->data = IMPL_NAME;
+    bus->release = stub_i2c_release;
+
+    return bus;
+}
+
+static struct gpw_i2c_impl_entry stub_entry = {
+    .name = IMPL_NAME,
+    .create = stub_i2c_create,
+};
+
+#ifndef STUB_NO_INIT
+void CAT(gpiow_, STUB_NAME, _initialize)(void)
+{
+    gpw_i2c_bus_register(&stub_entry);
+}
+#endif
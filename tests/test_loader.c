@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 hanyazou
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <gpiow/gpiow.h>
+#include <gpiow/multi_impl.h>
+
+static int failures = 0;
+static int last_level;
+static char last_message[512];
+
+static void test_log_hook(int level, char *fmt, ...)
+{
+    va_list arg_ptr;
+
+    /* Keep the most severe message of the current case */
+    if (last_message[0] != '\0' && last_level <= level) {
+        return;
+    }
+    last_level = level;
+    va_start(arg_ptr, fmt);
+    vsnprintf(last_message, sizeof(last_message), fmt, arg_ptr);
+    va_end(arg_ptr);
+}
+
+static void expect_bus(char *uri, char *impl_name)
+{
+    struct gpw_i2c_bus *bus;
+
+    last_message[0] = '\0';
+    bus = gpw_i2c_bus_create(uri);
+    if (bus == NULL || bus->data == NULL || strcmp(bus->data, impl_name) != 0) {
+        printf("FAIL: %s: expected %s instance, %s\n", uri, impl_name, last_message);
+        failures++;
+    } else {
+        printf("ok: %s: %s\n", uri, impl_name);
+    }
+    gpw_i2c_bus_release(bus);
+}
+
+static void expect_error(char *uri, int level, char *message)
+{
+    struct gpw_i2c_bus *bus;
+
+    last_message[0] = '\0';
+    bus = gpw_i2c_bus_create(uri);
+    if (bus != NULL) {
+        printf("FAIL: %s: unexpected instance\n", uri);
+        failures++;
+        gpw_i2c_bus_release(bus);
+    } else if (last_level != level || strstr(last_message, message) == NULL) {
+        printf("FAIL: %s: expected \"%s\", got \"%s\"\n", uri, message, last_message);
+        failures++;
+    } else {
+        printf("ok: %s: %s\n", uri, last_message);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    gpiow_log_hook = test_log_hook;
+    gpiow_initialize();
+
+    expect_bus(NULL, "pigpiod");
+    expect_bus("stub:1", "stub");
+    expect_bus("stub", "stub");
+
+    expect_error("Stub:1", GPIOW_LOG_WARN, "invalid scheme");
+    expect_error("../stub:1", GPIOW_LOG_WARN, "invalid scheme");
+    expect_error("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa:1", GPIOW_LOG_WARN, "invalid scheme");
+    expect_error("noinit:1", GPIOW_LOG_ERROR, "gpiow_noinit_initialize not found");
+    expect_error("broken:1", GPIOW_LOG_ERROR, "can't load");
+    expect_error("missing:1", GPIOW_LOG_WARN, "no module for \"missing\"");
+
+    return failures ? 1 : 0;
+}